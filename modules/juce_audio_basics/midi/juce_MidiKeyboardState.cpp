@@ -26,6 +26,7 @@ namespace juce
 MidiKeyboardState::MidiKeyboardState()
 {
     zerostruct (noteStates);
+    zerostruct (noteOnMasks);
 }
 
 //==============================================================================
@@ -33,6 +34,7 @@ void MidiKeyboardState::reset()
 {
     const ScopedLock sl (lock);
     zerostruct (noteStates);
+    zerostruct (noteOnMasks);
     eventsToAdd.clear();
 }
 
@@ -50,6 +52,20 @@ bool MidiKeyboardState::isNoteOnForChannels (const int midiChannelMask, const in
             && (noteStates[n] & midiChannelMask) != 0;
 }
 
+void MidiKeyboardState::getNoteOnMaskForChannels (const int midiChannelMask, uint64& lowNotes, uint64& highNotes) const noexcept
+{
+    lowNotes = highNotes = 0;
+
+    for (int channel = 0; channel < 16; ++channel)
+    {
+        if ((midiChannelMask & (1 << channel)) != 0)
+        {
+            lowNotes  |= noteOnMasks[channel][0];
+            highNotes |= noteOnMasks[channel][1];
+        }
+    }
+}
+
 void MidiKeyboardState::noteOn (const int midiChannel, const int midiNoteNumber, const float velocity)
 {
     jassert (midiChannel > 0 && midiChannel <= 16);
@@ -72,6 +88,7 @@ void MidiKeyboardState::noteOnInternal  (const int midiChannel, const int midiNo
     if (isPositiveAndBelow (midiNoteNumber, 128))
     {
         noteStates[midiNoteNumber] = static_cast<uint16> (noteStates[midiNoteNumber] | (1 << (midiChannel - 1)));
+        noteOnMasks[midiChannel - 1][midiNoteNumber >> 6] |= 1ULL << (midiNoteNumber & 63);
         listeners.call ([&] (Listener& l) { l.handleNoteOn (this, midiChannel, midiNoteNumber, velocity); });
     }
 }
@@ -95,6 +112,7 @@ void MidiKeyboardState::noteOffInternal  (const int midiChannel, const int midiN
     if (isNoteOn (midiChannel, midiNoteNumber))
     {
         noteStates[midiNoteNumber] = static_cast<uint16> (noteStates[midiNoteNumber] & ~(1 << (midiChannel - 1)));
+        noteOnMasks[midiChannel - 1][midiNoteNumber >> 6] &= ~(1ULL << (midiNoteNumber & 63));
         listeners.call ([&] (Listener& l) { l.handleNoteOff (this, midiChannel, midiNoteNumber, velocity); });
     }
 }
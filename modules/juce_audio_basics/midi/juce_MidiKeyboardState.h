@@ -71,6 +71,16 @@ public:
     */
     bool isNoteOnForChannels (int midiChannelMask, int midiNoteNumber) const noexcept;
 
+    /** Returns a bitmask of all the keys that are currently held down on a set of midi channels.
+
+        The channel mask has a bit set for each midi channel you want to test for - bit
+        0 = midi channel 1, bit 1 = midi channel 2, etc.
+
+        On return, lowNotes holds one bit per midi note 0-63, and highNotes one bit per
+        midi note 64-127, set if the note is on for at least one of the specified channels.
+    */
+    void getNoteOnMaskForChannels (int midiChannelMask, uint64& lowNotes, uint64& highNotes) const noexcept;
+
     /** Turns a specified note on.
 
         This will cause a suitable midi note-on event to be injected into the midi buffer during the
@@ -181,6 +191,7 @@ private:
     //==============================================================================
     CriticalSection lock;
     std::atomic<uint16> noteStates[128];
+    std::atomic<uint64> noteOnMasks[16][2];
     MidiBuffer eventsToAdd;
     ListenerList<Listener> listeners;
 
@@ -29,6 +29,51 @@ namespace juce
 constexpr uint8 whiteNotes[] = { 0, 2, 4, 5, 7, 9, 11 };
 constexpr uint8 blackNotes[] = { 1, 3, 6, 8, 10 };
 
+static constexpr uint64 getBlackKeyMaskWord (int wordBase) noexcept
+{
+    uint64 mask = 0;
+
+    for (int bit = 0; bit < 64; ++bit)
+        for (auto noteNum : blackNotes)
+            if ((wordBase + bit) % 12 == noteNum)
+                mask |= 1ULL << bit;
+
+    return mask;
+}
+
+// One bit per midi note, set for the black keys, so that classifying a note or
+// visiting all the keys of one colour needs no per-note modulo arithmetic.
+constexpr uint64 blackKeyMask[] = { getBlackKeyMaskWord (0), getBlackKeyMaskWord (64) };
+
+static bool isBlackKey (int midiNoteNumber) noexcept
+{
+    return (blackKeyMask[midiNoteNumber >> 6] & (1ULL << (midiNoteNumber & 63))) != 0;
+}
+
+static int countTrailingZeroBits (uint64 word) noexcept
+{
+   #if JUCE_GCC || JUCE_CLANG
+    return __builtin_ctzll (word);
+   #else
+    int result = 0;
+
+    for (; (word & 1) == 0; word >>= 1)
+        ++result;
+
+    return result;
+   #endif
+}
+
+static uint64 noteMaskForRange (int firstNote, int lastNote, int wordBase) noexcept
+{
+    const auto bitsBelow = [] (int n) { return n >= 64 ? ~0ULL : (1ULL << n) - 1; };
+
+    const auto lo = jlimit (0, 64, firstNote - wordBase);
+    const auto hi = jlimit (0, 64, lastNote + 1 - wordBase);
+
+    return lo < hi ? (bitsBelow (hi) & ~bitsBelow (lo)) : 0;
+}
+
 //==============================================================================
 struct KeyboardComponentBase::UpDownButton final : public Button
 {
@@ -219,9 +264,69 @@ KeyboardComponentBase::NoteAndVelocity KeyboardComponentBase::getNoteAndVelocity
             p = { (float) getHeight() - p.x, p.y };
     }
 
+    if (noteLUTDirty)
+        rebuildNoteLUT();
+
+    // The lookup tables give the key intersecting each pixel column, so most
+    // positions resolve with a single load; a candidate that fails the exact range
+    // test (the key boundary lies within its column) falls back to the full search.
+    if (const auto x = (int) p.x; isPositiveAndBelow (x, (int) whiteNoteLUT.size()))
+    {
+        const auto blackNoteLength = getBlackNoteLength();
+
+        if (p.y < blackNoteLength)
+        {
+            if (const int note = blackNoteLUT[(size_t) x]; note >= 0)
+            {
+                if (getKeyPos (note).contains (p.x))
+                    return { note, jmax (0.0f, p.y / blackNoteLength) };
+
+                return remappedXYToNote (p + Point<float> (xOffset, 0));
+            }
+        }
+
+        if (const int note = whiteNoteLUT[(size_t) x]; note >= 0)
+        {
+            if (getKeyPos (note).contains (p.x))
+            {
+                const auto whiteNoteLength = (orientation == horizontalKeyboard) ? getHeight() : getWidth();
+                return { note, jmax (0.0f, p.y / (float) whiteNoteLength) };
+            }
+        }
+        else
+        {
+            return { -1, 0.0f };
+        }
+    }
+
     return remappedXYToNote (p + Point<float> (xOffset, 0));
 }
 
+void KeyboardComponentBase::rebuildNoteLUT()
+{
+    const auto numColumns = jmax (0, orientation == horizontalKeyboard ? getWidth() : getHeight());
+
+    whiteNoteLUT.assign ((size_t) numColumns, (int8) -1);
+    blackNoteLUT.assign ((size_t) numColumns, (int8) -1);
+
+    for (int note = rangeStart; note <= rangeEnd; ++note)
+    {
+        auto& lut = isBlackKey (note) ? blackNoteLUT : whiteNoteLUT;
+        const auto pos = getKeyPos (note);
+
+        const auto firstColumn = jmax (0, (int) std::floor (pos.getStart()));
+        const auto lastColumn  = jmin (numColumns - 1, (int) std::ceil (pos.getEnd()) - 1);
+
+        // first-write-wins, so a column shared by two keys keeps the lower one,
+        // which is the key that contains the column's left-hand edge
+        for (int x = firstColumn; x <= lastColumn; ++x)
+            if (lut[(size_t) x] < 0)
+                lut[(size_t) x] = (int8) note;
+    }
+
+    noteLUTDirty = false;
+}
+
 KeyboardComponentBase::NoteAndVelocity KeyboardComponentBase::remappedXYToNote (Point<float> pos) const
 {
     auto blackNoteLength = getBlackNoteLength();
@@ -273,7 +378,7 @@ Rectangle<float> KeyboardComponentBase::getRectangleForKey (int note) const
     auto x = pos.getStart();
     auto w = pos.getLength();
 
-    if (MidiMessage::isMidiNoteBlack (note))
+    if (isBlackKey (note))
     {
         auto blackNoteLength = getBlackNoteLength();
 
@@ -347,7 +452,7 @@ Range<float> KeyboardComponentBase::getKeyPosition (int midiNoteNumber, float ta
     auto note   = midiNoteNumber % 12;
 
     auto start = (float) octave * 7.0f * targetKeyWidth + notePos[note] * targetKeyWidth;
-    auto width = MidiMessage::isMidiNoteBlack (note) ? blackNoteWidthRatio * targetKeyWidth : targetKeyWidth;
+    auto width = isBlackKey (note) ? blackNoteWidthRatio * targetKeyWidth : targetKeyWidth;
 
     return { start, start + width };
 }
@@ -357,28 +462,35 @@ void KeyboardComponentBase::paint (Graphics& g)
 {
     drawKeyboardBackground (g, getLocalBounds().toFloat());
 
-    for (int octaveBase = 0; octaveBase < 128; octaveBase += 12)
+    // Draw all the white keys first, then overlay the black keys. Scanning the set
+    // bits of the precomputed masks visits exactly the keys of each pass's colour
+    // within the available range, with no per-key classification.
+    for (const auto blackPass : { false, true })
     {
-        for (auto noteNum : whiteNotes)
+        for (int word = 0; word < 2; ++word)
         {
-            const auto key = octaveBase + noteNum;
+            const auto wordBase = word * 64;
+            auto keys = (blackPass ? blackKeyMask[word] : ~blackKeyMask[word])
+                          & noteMaskForRange (rangeStart, rangeEnd, wordBase);
 
-            if (rangeStart <= key && key <= rangeEnd)
-                drawWhiteKey (key, g, getRectangleForKey (key));
-        }
-
-        for (auto noteNum : blackNotes)
-        {
-            const auto key = octaveBase + noteNum;
+            while (keys != 0)
+            {
+                const auto key = wordBase + countTrailingZeroBits (keys);
+                keys &= keys - 1;
 
-            if (rangeStart <= key && key <= rangeEnd)
-                drawBlackKey (key, g, getRectangleForKey (key));
+                if (blackPass)
+                    drawBlackKey (key, g, getRectangleForKey (key));
+                else
+                    drawWhiteKey (key, g, getRectangleForKey (key));
+            }
         }
     }
 }
 
 void KeyboardComponentBase::resized()
 {
+    noteLUTDirty = true;
+
     auto w = getWidth();
     auto h = getHeight();
 
@@ -272,6 +272,7 @@ private:
     Range<float> getKeyPos (int midiNoteNumber) const;
     NoteAndVelocity remappedXYToNote (Point<float>) const;
     void setLowestVisibleKeyFloat (float noteNumber);
+    void rebuildNoteLUT();
 
     //==============================================================================
     Orientation orientation;
@@ -285,6 +286,9 @@ private:
     int rangeStart = 0, rangeEnd = 127;
     int octaveNumForMiddleC = 3;
 
+    std::vector<int8> whiteNoteLUT, blackNoteLUT;
+    bool noteLUTDirty = true;
+
     bool canScroll = true;
     std::unique_ptr<Button> scrollDown, scrollUp;
 
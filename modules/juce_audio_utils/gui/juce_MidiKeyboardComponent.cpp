@@ -26,6 +26,19 @@
 namespace juce
 {
 
+// countTrailingZeroBits and noteMaskForRange are shared with
+// juce_KeyboardComponentBase.cpp, which precedes this file in the module build.
+
+static uint64 getKeyPressLookupIndex (const KeyPress& key) noexcept
+{
+    // Normalised so that any two KeyPresses that can compare equal produce the same
+    // index: KeyPress equality is case-insensitive for character codes.
+    const auto code = key.getKeyCode() < 256 ? (int) CharacterFunctions::toLowerCase ((juce_wchar) key.getKeyCode())
+                                             : key.getKeyCode();
+
+    return (uint64) (uint32) code | ((uint64) (uint32) key.getModifiers().getRawFlags() << 32);
+}
+
 //==============================================================================
 MidiKeyboardComponent::MidiKeyboardComponent (MidiKeyboardState& stateToUse, Orientation orientationToUse)
     : KeyboardComponentBase (orientationToUse), state (stateToUse)
@@ -33,23 +46,39 @@ MidiKeyboardComponent::MidiKeyboardComponent (MidiKeyboardState& stateToUse, Ori
     state.addListener (this);
 
     // initialise with a default set of qwerty key-mappings.
-    const std::string_view keys { "awsedftgyhujkolp;" };
+    static constexpr char keys[] = "awsedftgyhujkolp;";
+    constexpr auto numKeys = (int) sizeof (keys) - 1;
 
-    for (const char& c : keys)
-        setKeyPressForNote ({c, 0, 0}, (int) std::distance (keys.data(), &c));
+    keyPressNotes.ensureStorageAllocated (numKeys);
+    keyPresses.ensureStorageAllocated (numKeys);
+
+    // the mapping lists are known to be empty here, so the notes can be appended
+    // directly without going through setKeyPressForNote's remove-first logic
+    for (int i = 0; i < numKeys; ++i)
+    {
+        const KeyPress key (keys[i], 0, 0);
+
+        keyPressNotes.add (i);
+        keyPresses.add (key);
+        ++keyPressLookup[getKeyPressLookupIndex (key)];
+    }
 
     mouseOverNotes.insertMultiple (0, -1, 32);
     mouseDownNotes.insertMultiple (0, -1, 32);
+    pendingPointerPositions.insertMultiple (0, {}, 32);
+    pendingPointerNotes.insertMultiple (0, { -1, 0.0f }, 32);
+    hoverKeyRects.insertMultiple (0, {}, 32);
+
+    rebuildKeyRectCache();
 
     colourChanged();
     setWantsKeyboardFocus (true);
-
-    startTimerHz (20);
 }
 
 MidiKeyboardComponent::~MidiKeyboardComponent()
 {
     state.removeListener (this);
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -74,7 +103,7 @@ void MidiKeyboardComponent::setMidiChannel (int midiChannelNumber)
 void MidiKeyboardComponent::setMidiChannelsToDisplay (int midiChannelMask)
 {
     midiInChannelMask = midiChannelMask;
-    noPendingUpdates.store (false);
+    triggerAsyncUpdate();
 }
 
 //==============================================================================
@@ -83,6 +112,7 @@ void MidiKeyboardComponent::clearKeyMappings()
     resetAnyKeysInUse();
     keyPressNotes.clear();
     keyPresses.clear();
+    keyPressLookup.clear();
 }
 
 void MidiKeyboardComponent::setKeyPressForNote (const KeyPress& key, int midiNoteOffsetFromC)
@@ -91,16 +121,28 @@ void MidiKeyboardComponent::setKeyPressForNote (const KeyPress& key, int midiNot
 
     keyPressNotes.add (midiNoteOffsetFromC);
     keyPresses.add (key);
+    ++keyPressLookup[getKeyPressLookupIndex (key)];
 }
 
 void MidiKeyboardComponent::removeKeyPressForNote (int midiNoteOffsetFromC)
 {
+    // The mapping lists are unordered, so removals can swap the last entry into the
+    // vacated slot rather than shuffling everything down.
     for (int i = keyPressNotes.size(); --i >= 0;)
     {
         if (keyPressNotes.getUnchecked (i) == midiNoteOffsetFromC)
         {
-            keyPressNotes.remove (i);
-            keyPresses.remove (i);
+            const auto lookupIndex = getKeyPressLookupIndex (keyPresses.getReference (i));
+
+            if (--keyPressLookup[lookupIndex] <= 0)
+                keyPressLookup.erase (lookupIndex);
+
+            const auto last = keyPressNotes.size() - 1;
+
+            keyPressNotes.swap (i, last);
+            keyPresses.swap (i, last);
+            keyPressNotes.removeLast();
+            keyPresses.removeLast();
         }
     }
 }
@@ -115,15 +157,22 @@ void MidiKeyboardComponent::setKeyPressBaseOctave (int newOctaveNumber)
 //==============================================================================
 void MidiKeyboardComponent::resetAnyKeysInUse()
 {
-    if (! keysPressed.isZero())
+    pendingKeysPressed = {};
+    hasPendingKeysPressed = false;
+
+    for (int word = 0; word < 2; ++word)
     {
-        for (int i = 128; --i >= 0;)
-            if (keysPressed[i])
-                state.noteOff (midiChannel, i, 0.0f);
+        auto held = keysPressed[(size_t) word];
 
-        keysPressed.clear();
+        while (held != 0)
+        {
+            state.noteOff (midiChannel, word * 64 + countTrailingZeroBits (held), 0.0f);
+            held &= held - 1;
+        }
     }
 
+    keysPressed = {};
+
     for (int i = mouseDownNotes.size(); --i >= 0;)
     {
         auto noteDown = mouseDownNotes.getUnchecked (i);
@@ -131,31 +180,135 @@ void MidiKeyboardComponent::resetAnyKeysInUse()
         if (noteDown >= 0)
         {
             state.noteOff (midiChannel, noteDown, 0.0f);
-            mouseDownNotes.set (i, -1);
+            setMouseDownNote (i, -1);
         }
 
-        mouseOverNotes.set (i, -1);
+        setMouseOverNote (i, -1);
+    }
+}
+
+// The note masks are only ever written from the message thread, so these
+// read-modify-writes don't race; the atomics just give any other thread that
+// happens to paint or query them a tear-free snapshot.
+static void setBitInNoteMask (std::atomic<uint64>* mask, int note, bool shouldBeSet) noexcept
+{
+    auto& word = mask[note >> 6];
+    const auto bit = 1ULL << (note & 63);
+
+    word.store (shouldBeSet ? (word.load (std::memory_order_relaxed) | bit)
+                            : (word.load (std::memory_order_relaxed) & ~bit),
+                std::memory_order_relaxed);
+}
+
+static bool isBitSetInNoteMask (const std::atomic<uint64>* mask, int note) noexcept
+{
+    return (mask[note >> 6].load (std::memory_order_relaxed) & (1ULL << (note & 63))) != 0;
+}
+
+void MidiKeyboardComponent::setMouseOverNote (int fingerNum, int newNote)
+{
+    auto oldNote = mouseOverNotes.getUnchecked (fingerNum);
+
+    if (oldNote != newNote)
+    {
+        if (oldNote >= 0 && --mouseOverNoteCounts[oldNote] == 0)
+            setBitInNoteMask (mouseOverNoteMask, oldNote, false);
+
+        if (newNote >= 0 && mouseOverNoteCounts[newNote]++ == 0)
+            setBitInNoteMask (mouseOverNoteMask, newNote, true);
+
+        mouseOverNotes.set (fingerNum, newNote);
     }
 }
 
+void MidiKeyboardComponent::setMouseDownNote (int fingerNum, int newNote)
+{
+    auto oldNote = mouseDownNotes.getUnchecked (fingerNum);
+
+    if (oldNote != newNote)
+    {
+        if (oldNote >= 0 && --mouseDownNoteCounts[oldNote] == 0)
+            setBitInNoteMask (mouseDownNoteMask, oldNote, false);
+
+        if (newNote >= 0 && mouseDownNoteCounts[newNote]++ == 0)
+            setBitInNoteMask (mouseDownNoteMask, newNote, true);
+
+        mouseDownNotes.set (fingerNum, newNote);
+    }
+}
+
+bool MidiKeyboardComponent::isMouseOverNote (int midiNoteNumber) const noexcept
+{
+    return isBitSetInNoteMask (mouseOverNoteMask, midiNoteNumber);
+}
+
+bool MidiKeyboardComponent::isMouseDownNote (int midiNoteNumber) const noexcept
+{
+    return isBitSetInNoteMask (mouseDownNoteMask, midiNoteNumber);
+}
+
 void MidiKeyboardComponent::updateNoteUnderMouse (const MouseEvent& e, bool isDown)
 {
     updateNoteUnderMouse (e.getEventRelativeTo (this).position, isDown, e.source.getIndex());
 }
 
+Rectangle<float> MidiKeyboardComponent::getUnambiguousKeyBounds (int midiNoteNumber) const
+{
+    auto bounds = getRectangleForKey (midiNoteNumber);
+
+    // The rectangle of a white key also covers the band occupied by the black keys,
+    // so trim it down to the part where a hit-test can only return this key.
+    if (! isBlackKey (midiNoteNumber))
+    {
+        const auto blackNoteLength = getBlackNoteLength();
+
+        switch (getOrientation())
+        {
+            case horizontalKeyboard:            bounds = bounds.withTrimmedTop   (blackNoteLength); break;
+            case verticalKeyboardFacingLeft:    bounds = bounds.withTrimmedRight (blackNoteLength); break;
+            case verticalKeyboardFacingRight:   bounds = bounds.withTrimmedLeft  (blackNoteLength); break;
+            default:                            break;
+        }
+    }
+
+    return bounds;
+}
+
 void MidiKeyboardComponent::updateNoteUnderMouse (Point<float> pos, bool isDown, int fingerNum)
 {
-    const auto noteInfo = getNoteAndVelocityAtPosition (pos);
-    const auto newNote = noteInfo.note;
     const auto oldNote = mouseOverNotes.getUnchecked (fingerNum);
     const auto oldNoteDown = mouseDownNotes.getUnchecked (fingerNum);
+
+    // If the pointer is still inside the key it was last seen over and its up/down
+    // state hasn't changed, nothing below can have any effect, so skip the hit-test.
+    if (oldNote >= 0
+         && (isDown ? oldNoteDown == oldNote : oldNoteDown < 0)
+         && hoverKeyRects.getReference (fingerNum).contains (pos))
+        return;
+
+    updateNoteUnderMouse (getNoteAndVelocityAtPosition (pos), isDown, fingerNum);
+}
+
+void MidiKeyboardComponent::updateNoteUnderMouse (const NoteAndVelocity& noteInfo, bool isDown, int fingerNum)
+{
+    const auto oldNote = mouseOverNotes.getUnchecked (fingerNum);
+    const auto oldNoteDown = mouseDownNotes.getUnchecked (fingerNum);
+    const auto newNote = noteInfo.note;
+
+    hoverKeyRects.set (fingerNum, newNote >= 0 ? getUnambiguousKeyBounds (newNote)
+                                               : Rectangle<float>());
     const auto eventVelocity = useMousePositionForVelocity ? noteInfo.velocity * velocity : velocity;
 
     if (oldNote != newNote)
     {
-        repaintNote (oldNote);
-        repaintNote (newNote);
-        mouseOverNotes.set (fingerNum, newNote);
+        // For adjacent keys this coalesces the two damaged areas into a single
+        // repaint region rather than invalidating them separately.
+        const auto dirty = getKeyRepaintBounds (oldNote).getUnion (getKeyRepaintBounds (newNote));
+
+        if (! dirty.isEmpty())
+            repaint (dirty);
+
+        setMouseOverNote (fingerNum, newNote);
     }
 
     if (isDown)
@@ -164,64 +317,149 @@ void MidiKeyboardComponent::updateNoteUnderMouse (Point<float> pos, bool isDown,
         {
             if (oldNoteDown >= 0)
             {
-                mouseDownNotes.set (fingerNum, -1);
+                setMouseDownNote (fingerNum, -1);
 
-                if (! mouseDownNotes.contains (oldNoteDown))
+                if (! isMouseDownNote (oldNoteDown))
                     state.noteOff (midiChannel, oldNoteDown, eventVelocity);
             }
 
-            if (newNote >= 0 && ! mouseDownNotes.contains (newNote))
+            if (newNote >= 0 && ! isMouseDownNote (newNote))
             {
                 state.noteOn (midiChannel, newNote, eventVelocity);
-                mouseDownNotes.set (fingerNum, newNote);
+                setMouseDownNote (fingerNum, newNote);
             }
         }
     }
     else if (oldNoteDown >= 0)
     {
-        mouseDownNotes.set (fingerNum, -1);
+        setMouseDownNote (fingerNum, -1);
 
-        if (! mouseDownNotes.contains (oldNoteDown))
+        if (! isMouseDownNote (oldNoteDown))
             state.noteOff (midiChannel, oldNoteDown, eventVelocity);
     }
 }
 
-void MidiKeyboardComponent::repaintNote (int noteNum)
+void MidiKeyboardComponent::deferNoteUnderMouseUpdate (const MouseEvent& e, bool isDown)
+{
+    // Mouse-move and drag events can arrive much faster than the display can repaint,
+    // so rather than doing the hit-testing and repainting per event, just remember the
+    // most recent position for this pointer and let the timer process it once per tick.
+    const auto fingerNum = e.source.getIndex();
+    const auto fingerBit = (uint32) 1 << fingerNum;
+
+    pendingPointerPositions.set (fingerNum, e.getEventRelativeTo (this).position);
+    pendingPointerFingers |= fingerBit;
+    pendingPointerKnownNotes &= ~fingerBit;
+
+    if (isDown)
+        pendingPointerDownStates |= fingerBit;
+    else
+        pendingPointerDownStates &= ~fingerBit;
+
+    if (! isTimerRunning())
+        startTimerHz (60);
+}
+
+void MidiKeyboardComponent::deferNoteUnderMouseUpdate (const MouseEvent& e, bool isDown, const NoteAndVelocity& noteInfo)
+{
+    // Used when the caller has already hit-tested the position, so the timer can
+    // reuse the result instead of repeating the lookup.
+    deferNoteUnderMouseUpdate (e, isDown);
+
+    const auto fingerNum = e.source.getIndex();
+
+    pendingPointerNotes.set (fingerNum, noteInfo);
+    pendingPointerKnownNotes |= (uint32) 1 << fingerNum;
+}
+
+void MidiKeyboardComponent::cancelPendingNoteUnderMouseUpdate (const MouseEvent& e)
+{
+    pendingPointerFingers &= ~((uint32) 1 << e.source.getIndex());
+}
+
+void MidiKeyboardComponent::processPendingNoteUnderMouseUpdates()
+{
+    if (pendingPointerFingers == 0)
+        return;
+
+    for (int fingerNum = 0; fingerNum < 32; ++fingerNum)
+    {
+        const auto fingerBit = (uint32) 1 << fingerNum;
+
+        if ((pendingPointerFingers & fingerBit) != 0)
+        {
+            const auto isDown = (pendingPointerDownStates & fingerBit) != 0;
+
+            if ((pendingPointerKnownNotes & fingerBit) != 0)
+                updateNoteUnderMouse (pendingPointerNotes.getUnchecked (fingerNum), isDown, fingerNum);
+            else
+                updateNoteUnderMouse (pendingPointerPositions.getUnchecked (fingerNum), isDown, fingerNum);
+        }
+    }
+
+    pendingPointerFingers = 0;
+}
+
+Rectangle<int> MidiKeyboardComponent::getKeyRepaintBounds (int noteNum) const
 {
     if (getRangeStart() <= noteNum && noteNum <= getRangeEnd())
-        repaint (getRectangleForKey (noteNum).getSmallestIntegerContainer());
+        return keyRectCache[(size_t) noteNum];
+
+    return {};
+}
+
+void MidiKeyboardComponent::rebuildKeyRectCache()
+{
+    // getRectangleForKey involves key classification and orientation maths, so work
+    // out each key's bounds once per layout change rather than on every repaint.
+    keyRectCache.fill ({});
+
+    for (int note = getRangeStart(); note <= getRangeEnd(); ++note)
+        keyRectCache[(size_t) note] = getRectangleForKey (note).getSmallestIntegerContainer();
+}
+
+void MidiKeyboardComponent::repaintNote (int noteNum)
+{
+    const auto bounds = getKeyRepaintBounds (noteNum);
+
+    if (! bounds.isEmpty())
+        repaint (bounds);
 }
 
 
 void MidiKeyboardComponent::mouseMove (const MouseEvent& e)
 {
-    updateNoteUnderMouse (e, false);
+    deferNoteUnderMouseUpdate (e, false);
 }
 
 void MidiKeyboardComponent::mouseDrag (const MouseEvent& e)
 {
-    auto newNote = getNoteAndVelocityAtPosition (e.position).note;
+    const auto noteInfo = getNoteAndVelocityAtPosition (e.position);
 
-    if (newNote >= 0 && mouseDraggedToKey (newNote, e))
-        updateNoteUnderMouse (e, true);
+    if (noteInfo.note >= 0 && mouseDraggedToKey (noteInfo.note, e))
+        deferNoteUnderMouseUpdate (e, true, noteInfo);
 }
 
 void MidiKeyboardComponent::mouseDown (const MouseEvent& e)
 {
-    auto newNote = getNoteAndVelocityAtPosition (e.position).note;
+    const auto noteInfo = getNoteAndVelocityAtPosition (e.position);
+
+    cancelPendingNoteUnderMouseUpdate (e);
 
-    if (newNote >= 0 && mouseDownOnKey (newNote, e))
-        updateNoteUnderMouse (e, true);
+    if (noteInfo.note >= 0 && mouseDownOnKey (noteInfo.note, e))
+        updateNoteUnderMouse (noteInfo, true, e.source.getIndex());
 }
 
 void MidiKeyboardComponent::mouseUp (const MouseEvent& e)
 {
-    updateNoteUnderMouse (e, false);
+    cancelPendingNoteUnderMouseUpdate (e);
+
+    const auto noteInfo = getNoteAndVelocityAtPosition (e.position);
 
-    auto note = getNoteAndVelocityAtPosition (e.position).note;
+    updateNoteUnderMouse (noteInfo, false, e.source.getIndex());
 
-    if (note >= 0)
-        mouseUpOnKey (note, e);
+    if (noteInfo.note >= 0)
+        mouseUpOnKey (noteInfo.note, e);
 }
 
 void MidiKeyboardComponent::mouseEnter (const MouseEvent& e)
@@ -231,60 +469,117 @@ void MidiKeyboardComponent::mouseEnter (const MouseEvent& e)
 
 void MidiKeyboardComponent::mouseExit (const MouseEvent& e)
 {
+    cancelPendingNoteUnderMouseUpdate (e);
     updateNoteUnderMouse (e, false);
 }
 
+void MidiKeyboardComponent::resized()
+{
+    KeyboardComponentBase::resized();
+
+    rebuildKeyRectCache();
+
+    // the cached hit-test rectangles are no longer valid
+    for (int i = hoverKeyRects.size(); --i >= 0;)
+        hoverKeyRects.set (i, {});
+}
+
 void MidiKeyboardComponent::timerCallback()
 {
-    if (noPendingUpdates.exchange (true))
-        return;
+    processPendingNoteUnderMouseUpdates();
+
+    // the timer only needs to run while pointer updates are being coalesced
+    if (pendingPointerFingers == 0)
+        stopTimer();
+}
 
-    for (auto i = getRangeStart(); i <= getRangeEnd(); ++i)
+void MidiKeyboardComponent::handleAsyncUpdate()
+{
+    if (hasPendingKeysPressed)
     {
-        const auto isOn = state.isNoteOnForChannels (midiInChannelMask, i);
+        hasPendingKeysPressed = false;
+
+        const auto desired = pendingKeysPressed;
 
-        if (keysCurrentlyDrawnDown[i] != isOn)
+        for (int word = 0; word < 2; ++word)
         {
-            keysCurrentlyDrawnDown.setBit (i, isOn);
-            repaintNote (i);
+            auto changed = desired[(size_t) word] ^ keysPressed[(size_t) word];
+
+            while (changed != 0)
+            {
+                const auto bit = changed & (0 - changed);
+                changed &= changed - 1;
+
+                const auto note = word * 64 + countTrailingZeroBits (bit);
+
+                if ((desired[(size_t) word] & bit) != 0)
+                    state.noteOn (midiChannel, note, velocity);
+                else
+                    state.noteOff (midiChannel, note, 0.0f);
+            }
         }
+
+        keysPressed = desired;
     }
+
+    uint64 noteOnMask[2];
+    state.getNoteOnMaskForChannels (midiInChannelMask, noteOnMask[0], noteOnMask[1]);
+
+    Rectangle<int> dirty;
+
+    for (int word = 0; word < 2; ++word)
+    {
+        const auto wordBase = word * 64;
+        auto changed = (noteOnMask[word] ^ keysCurrentlyDrawnDown[word])
+                         & noteMaskForRange (getRangeStart(), getRangeEnd(), wordBase);
+
+        while (changed != 0)
+        {
+            dirty = dirty.getUnion (getKeyRepaintBounds (wordBase + countTrailingZeroBits (changed)));
+            changed &= changed - 1;
+        }
+
+        keysCurrentlyDrawnDown[word] = noteOnMask[word];
+    }
+
+    if (! dirty.isEmpty())
+        repaint (dirty);
 }
 
 bool MidiKeyboardComponent::keyStateChanged (bool /*isKeyDown*/)
 {
-    bool keyPressUsed = false;
+    std::array<uint64, 2> desired = {};
 
     for (int i = keyPresses.size(); --i >= 0;)
     {
-        auto note = 12 * keyMappingOctave + keyPressNotes.getUnchecked (i);
-
         if (keyPresses.getReference (i).isCurrentlyDown())
         {
-            if (! keysPressed[note])
-            {
-                keysPressed.setBit (note);
-                state.noteOn (midiChannel, note, velocity);
-                keyPressUsed = true;
-            }
-        }
-        else
-        {
-            if (keysPressed[note])
-            {
-                keysPressed.clearBit (note);
-                state.noteOff (midiChannel, note, 0.0f);
-                keyPressUsed = true;
-            }
+            const auto note = 12 * keyMappingOctave + keyPressNotes.getUnchecked (i);
+
+            if (isPositiveAndBelow (note, 128))
+                desired[(size_t) (note >> 6)] |= 1ULL << (note & 63);
         }
     }
 
-    return keyPressUsed;
+    // Rather than dispatching note on/offs while an OS key-repeat flood is still in
+    // progress, record the target state and drain it from the async updater - any
+    // further changes that arrive before then simply overwrite the same target.
+    if (desired == (hasPendingKeysPressed ? pendingKeysPressed : keysPressed))
+        return false;
+
+    pendingKeysPressed = desired;
+    hasPendingKeysPressed = true;
+    triggerAsyncUpdate();
+
+    return true;
 }
 
 bool MidiKeyboardComponent::keyPressed (const KeyPress& key)
 {
-    return keyPresses.contains (key);
+    // The lookup rejects unmapped keys without scanning the mapping list; a hit is
+    // confirmed with the exact KeyPress comparison.
+    return keyPressLookup.find (getKeyPressLookupIndex (key)) != keyPressLookup.end()
+            && keyPresses.contains (key);
 }
 
 void MidiKeyboardComponent::focusLost (FocusChangeType)
@@ -295,7 +590,7 @@ void MidiKeyboardComponent::focusLost (FocusChangeType)
 //==============================================================================
 void MidiKeyboardComponent::drawKeyboardBackground (Graphics& g, Rectangle<float> area)
 {
-    g.fillAll (findColour (whiteNoteColourId));
+    g.fillAll (whiteNoteColour);
 
     auto width = area.getWidth();
     auto height = area.getHeight();
@@ -317,7 +612,6 @@ void MidiKeyboardComponent::drawKeyboardBackground (Graphics& g, Rectangle<float
     }
 
     auto keyboardWidth = getRectangleForKey (getRangeEnd()).getRight();
-    auto shadowColour = findColour (shadowColourId);
 
     if (! shadowColour.isTransparent())
     {
@@ -334,11 +628,9 @@ void MidiKeyboardComponent::drawKeyboardBackground (Graphics& g, Rectangle<float
         }
     }
 
-    auto lineColour = findColour (keySeparatorLineColourId);
-
-    if (! lineColour.isTransparent())
+    if (! keySeparatorLineColour.isTransparent())
     {
-        g.setColour (lineColour);
+        g.setColour (keySeparatorLineColour);
 
         switch (currentOrientation)
         {
@@ -355,8 +647,8 @@ void MidiKeyboardComponent::drawWhiteNote (int midiNoteNumber, Graphics& g, Rect
 {
     auto c = Colours::transparentWhite;
 
-    if (isDown)  c = findColour (keyDownOverlayColourId);
-    if (isOver)  c = c.overlaidWith (findColour (mouseOverKeyOverlayColourId));
+    if (isDown)  c = keyDownOverlayColour;
+    if (isOver)  c = c.overlaidWith (mouseOverKeyOverlayColour);
 
     g.setColour (c);
     g.fillRect (area);
@@ -411,8 +703,8 @@ void MidiKeyboardComponent::drawBlackNote (int /*midiNoteNumber*/, Graphics& g,
 {
     auto c = noteFillColour;
 
-    if (isDown)  c = c.overlaidWith (findColour (keyDownOverlayColourId));
-    if (isOver)  c = c.overlaidWith (findColour (mouseOverKeyOverlayColourId));
+    if (isDown)  c = c.overlaidWith (keyDownOverlayColour);
+    if (isOver)  c = c.overlaidWith (mouseOverKeyOverlayColour);
 
     g.setColour (c);
     g.fillRect (area);
@@ -450,7 +742,17 @@ String MidiKeyboardComponent::getWhiteNoteText (int midiNoteNumber)
 
 void MidiKeyboardComponent::colourChanged()
 {
-    setOpaque (findColour (whiteNoteColourId).isOpaque());
+    // cache the colours used by the paint callbacks so that drawing each key
+    // doesn't have to walk the component and LookAndFeel colour tables
+    whiteNoteColour           = findColour (whiteNoteColourId);
+    blackNoteColour           = findColour (blackNoteColourId);
+    keySeparatorLineColour    = findColour (keySeparatorLineColourId);
+    mouseOverKeyOverlayColour = findColour (mouseOverKeyOverlayColourId);
+    keyDownOverlayColour      = findColour (keyDownOverlayColourId);
+    textLabelColour           = findColour (textLabelColourId);
+    shadowColour              = findColour (shadowColourId);
+
+    setOpaque (whiteNoteColour.isOpaque());
     repaint();
 }
 
@@ -458,24 +760,24 @@ void MidiKeyboardComponent::colourChanged()
 void MidiKeyboardComponent::drawWhiteKey (int midiNoteNumber, Graphics& g, Rectangle<float> area)
 {
     drawWhiteNote (midiNoteNumber, g, area, state.isNoteOnForChannels (midiInChannelMask, midiNoteNumber),
-                   mouseOverNotes.contains (midiNoteNumber), findColour (keySeparatorLineColourId), findColour (textLabelColourId));
+                   isMouseOverNote (midiNoteNumber), keySeparatorLineColour, textLabelColour);
 }
 
 void MidiKeyboardComponent::drawBlackKey (int midiNoteNumber, Graphics& g, Rectangle<float> area)
 {
     drawBlackNote (midiNoteNumber, g, area, state.isNoteOnForChannels (midiInChannelMask, midiNoteNumber),
-                   mouseOverNotes.contains (midiNoteNumber), findColour (blackNoteColourId));
+                   isMouseOverNote (midiNoteNumber), blackNoteColour);
 }
 
 //==============================================================================
 void MidiKeyboardComponent::handleNoteOn (MidiKeyboardState*, int /*midiChannel*/, int /*midiNoteNumber*/, float /*velocity*/)
 {
-    noPendingUpdates.store (false);
+    triggerAsyncUpdate();
 }
 
 void MidiKeyboardComponent::handleNoteOff (MidiKeyboardState*, int /*midiChannel*/, int /*midiNoteNumber*/, float /*velocity*/)
 {
-    noPendingUpdates.store (false);
+    triggerAsyncUpdate();
 }
 
 //==============================================================================
@@ -48,7 +48,8 @@ namespace juce
 */
 class JUCE_API  MidiKeyboardComponent  : public KeyboardComponentBase,
                                          private MidiKeyboardState::Listener,
-                                         private Timer
+                                         private Timer,
+                                         private AsyncUpdater
 {
 public:
     //==============================================================================
@@ -234,6 +235,10 @@ public:
     /** @internal */
     void timerCallback() override;
     /** @internal */
+    void handleAsyncUpdate() override;
+    /** @internal */
+    void resized() override;
+    /** @internal */
     bool keyStateChanged (bool isKeyDown) override;
     /** @internal */
     bool keyPressed (const KeyPress&) override;
@@ -253,8 +258,20 @@ private:
 
     //==============================================================================
     void resetAnyKeysInUse();
+    void setMouseOverNote (int fingerNum, int newNote);
+    void setMouseDownNote (int fingerNum, int newNote);
+    bool isMouseOverNote (int midiNoteNumber) const noexcept;
+    bool isMouseDownNote (int midiNoteNumber) const noexcept;
     void updateNoteUnderMouse (Point<float>, bool isDown, int fingerNum);
+    void updateNoteUnderMouse (const NoteAndVelocity&, bool isDown, int fingerNum);
     void updateNoteUnderMouse (const MouseEvent&, bool isDown);
+    void deferNoteUnderMouseUpdate (const MouseEvent&, bool isDown);
+    void deferNoteUnderMouseUpdate (const MouseEvent&, bool isDown, const NoteAndVelocity&);
+    void cancelPendingNoteUnderMouseUpdate (const MouseEvent&);
+    void processPendingNoteUnderMouseUpdates();
+    Rectangle<int> getKeyRepaintBounds (int midiNoteNumber) const;
+    Rectangle<float> getUnambiguousKeyBounds (int midiNoteNumber) const;
+    void rebuildKeyRectCache();
     void repaintNote (int midiNoteNumber);
 
     //==============================================================================
@@ -265,12 +282,24 @@ private:
     float velocity = 1.0f;
     bool useMousePositionForVelocity = true;
 
+    Colour whiteNoteColour, blackNoteColour, keySeparatorLineColour,
+           mouseOverKeyOverlayColour, keyDownOverlayColour,
+           textLabelColour, shadowColour;
+
     Array<int> mouseOverNotes, mouseDownNotes;
+    std::atomic<uint64> mouseOverNoteMask[2] = {}, mouseDownNoteMask[2] = {};
+    uint8 mouseOverNoteCounts[128] = {}, mouseDownNoteCounts[128] = {};
+    Array<Point<float>> pendingPointerPositions;
+    Array<NoteAndVelocity> pendingPointerNotes;
+    Array<Rectangle<float>> hoverKeyRects;
+    uint32 pendingPointerFingers = 0, pendingPointerDownStates = 0, pendingPointerKnownNotes = 0;
     Array<KeyPress> keyPresses;
     Array<int> keyPressNotes;
-    BigInteger keysPressed, keysCurrentlyDrawnDown;
-
-    std::atomic<bool> noPendingUpdates { true };
+    std::unordered_map<uint64, int> keyPressLookup;
+    std::array<uint64, 2> keysPressed = {}, pendingKeysPressed = {};
+    bool hasPendingKeysPressed = false;
+    uint64 keysCurrentlyDrawnDown[2] = {};
+    std::array<Rectangle<int>, 128> keyRectCache;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiKeyboardComponent)
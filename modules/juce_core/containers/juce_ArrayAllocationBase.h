@@ -89,17 +89,20 @@ public:
     void ensureAllocatedSize (int minNumElements)
     {
         if (minNumElements > numAllocated)
-            setAllocatedSize ((minNumElements + minNumElements / 2 + 8) & ~7);
+            setAllocatedSize (jmax (minNumElements, numAllocated * 2, 16));
 
         jassert (numAllocated <= 0 || elements != nullptr);
     }
 
     /** Minimises the amount of storage allocated so that it's no more than
         the given number of elements.
+
+        To avoid repeatedly resizing the block, this only reallocates when doing
+        so would release a substantial proportion of the current allocation.
     */
     void shrinkToNoMoreThan (int maxNumElements)
     {
-        if (maxNumElements < numAllocated)
+        if (maxNumElements < numAllocated / 4)
             setAllocatedSize (maxNumElements);
     }
 
@@ -225,14 +225,16 @@ public:
     void ensureAllocatedSize (int minNumElements)
     {
         if (minNumElements > numAllocated)
-            setAllocatedSize ((minNumElements + minNumElements / 2 + 8) & ~7);
+            setAllocatedSize (jmax (minNumElements, numAllocated * 2, 16));
 
         jassert (numAllocated <= 0 || elements != nullptr);
     }
 
     void shrinkToNoMoreThan (int maxNumElements)
     {
-        if (maxNumElements < numAllocated)
+        // Only reallocate when it releases a substantial amount of storage, so that
+        // add/remove patterns near an allocation boundary don't keep resizing the block.
+        if (maxNumElements < numAllocated / 4)
             setAllocatedSize (maxNumElements);
     }
 